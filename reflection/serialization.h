@@ -1,17 +1,25 @@
 #ifndef SERIALIZATION_H
 #define SERIALIZATION_H
 
+#include <array>
+#include <bitset>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <json/json.h>
 #include <list>
 #include <map>
+#include <optional>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string.h>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 //#include "reflection.h"
 
@@ -22,6 +30,48 @@ class BinaryDeserializer;
 class JsonSerializer;
 class JsonDeserializer;
 
+// std::vector<bool> hands out proxy references, so it gets its own bit-packed overloads
+inline void serialize(BinarySerializer &s, std::vector<bool> &obj);
+inline void deserialize(BinaryDeserializer &s, std::vector<bool> &obj);
+inline void serialize(Json::Value &val, const std::string &name, std::vector<bool> &obj);
+inline void deserialize(Json::Value &val, const std::string &name, std::vector<bool> &obj);
+
+// Json::Value gives no ADL into Vernon, so nested Json overloads have to be declared before they are used
+template <typename SerializableTypeA, typename SerializableTypeB>
+void serialize(Json::Value &val, const std::string &name, std::pair<SerializableTypeA, SerializableTypeB> &obj);
+template <typename... SerializableTypes>
+void serialize(Json::Value &val, const std::string &name, std::tuple<SerializableTypes...> &obj);
+template <typename SerializableType, size_t N>
+void serialize(Json::Value &val, const std::string &name, std::array<SerializableType, N> &obj);
+template <typename SerializableType>
+void serialize(Json::Value &val, const std::string &name, std::deque<SerializableType> &obj);
+template <typename SerializableType>
+void serialize(Json::Value &val, const std::string &name, std::optional<SerializableType> &obj);
+template <typename... SerializableTypes>
+void serialize(Json::Value &val, const std::string &name, std::variant<SerializableTypes...> &obj);
+template <size_t N> void serialize(Json::Value &val, const std::string &name, std::bitset<N> &obj);
+
+template <typename SerializableTypeA, typename SerializableTypeB>
+void deserialize(Json::Value &val, const std::string &name, std::pair<SerializableTypeA, SerializableTypeB> &obj);
+template <typename... SerializableTypes>
+void deserialize(Json::Value &val, const std::string &name, std::tuple<SerializableTypes...> &obj);
+template <typename SerializableType, size_t N>
+void deserialize(Json::Value &val, const std::string &name, std::array<SerializableType, N> &obj);
+template <typename SerializableType>
+void deserialize(Json::Value &val, const std::string &name, std::deque<SerializableType> &obj);
+template <typename SerializableType>
+void deserialize(Json::Value &val, const std::string &name, std::optional<SerializableType> &obj);
+template <typename... SerializableTypes>
+void deserialize(Json::Value &val, const std::string &name, std::variant<SerializableTypes...> &obj);
+template <size_t N> void deserialize(Json::Value &val, const std::string &name, std::bitset<N> &obj);
+
+// basic types are stored as native Json values; raw byte strings don't survive the Json writer's utf-8 escaping
+template <typename Type>
+using JsonBasicType = std::conditional_t<
+    std::is_same<Type, bool>::value, bool,
+    std::conditional_t<std::is_floating_point<Type>::value, double,
+                       std::conditional_t<std::is_signed<Type>::value, Json::Int64, Json::UInt64>>>;
+
 #define BASIC_TYPE_SERIALIZE(Type)                                                                                     \
     template <> void serialize(BinarySerializer &s, Type &obj) {                                                       \
         std::string ret;                                                                                               \
@@ -29,25 +79,54 @@ class JsonDeserializer;
         s.outStream().write(ret.data(), ret.size());                                                                   \
     }                                                                                                                  \
     template <> void serialize(Json::Value &val, const std::string &name, Type &obj) {                                 \
-        std::string ret;                                                                                               \
-        ret.append((const char *)&obj, sizeof(int));                                                                   \
-        val[name] = ret;                                                                                               \
+        val[name] = static_cast<JsonBasicType<Type>>(obj);                                                             \
     }
 
 #define BASIC_TYPE_DESERIALIZE(Type)                                                                                   \
     template <> void deserialize(BinaryDeserializer &s, Type &obj) {                                                   \
+        checkRemaining(s, sizeof(Type));                                                                               \
         memcpy(&obj, s.str().data(), sizeof(Type));                                                                    \
         s.str() = s.str().substr(sizeof(Type));                                                                        \
     }                                                                                                                  \
     template <> void deserialize(Json::Value &val, const std::string &name, Type &obj) {                               \
-        memcpy(&obj, val[name].asString().data(), sizeof(Type));                                                       \
+        if (!val[name].isString()) {                                                                                   \
+            obj = static_cast<Type>(val[name].as<JsonBasicType<Type>>());                                              \
+            return;                                                                                                    \
+        }                                                                                                              \
+        std::string ret = val[name].asString();                                                                        \
+        if (ret.size() >= sizeof(Type))                                                                                \
+            memcpy(&obj, ret.data(), sizeof(Type));                                                                    \
+        else                                                                                                           \
+            obj = {};                                                                                                  \
     }
 
 #define BASIC_TYPE_SERIALIZE_AND_DESERIALIZE(Type)                                                                     \
     BASIC_TYPE_SERIALIZE(Type)                                                                                         \
     BASIC_TYPE_DESERIALIZE(Type)
 
-template <typename SerializableType> void serialize(BinarySerializer &s, SerializableType &obj) { obj.serialize(s); }
+// bit i of the container goes to bit (i % 8) of byte (i / 8)
+template <typename BitContainer> std::string packBits(BitContainer &bits, size_t len) {
+    std::string ret((len + 7) / 8, '\0');
+    for (size_t i = 0; i < len; ++i) {
+        if (bits[i])
+            ret[i / 8] |= 1 << (i % 8);
+    }
+    return ret;
+}
+
+inline bool unpackBit(const char *data, size_t i) { return (data[i / 8] >> (i % 8)) & 1; }
+
+// throws before a decoder reads past the end of the remaining binary
+inline void checkRemaining(BinaryDeserializer &s, size_t size);
+
+template <typename SerializableType> void serialize(BinarySerializer &s, SerializableType &obj) {
+    if constexpr (std::is_enum<SerializableType>::value) {
+        auto tmp = static_cast<std::underlying_type_t<SerializableType>>(obj);
+        serialize(s, tmp);
+    } else {
+        obj.serialize(s);
+    }
+}
 
 template <typename SerializableType> void serialize(BinarySerializer &s, SerializableType *ptr) { ptr->serialize(s); }
 
@@ -112,6 +191,10 @@ public:
         serialize(*this, obj);
         return *this;
     }
+    BinarySerializer &operator<<(std::vector<bool> &obj) {
+        serialize(*this, obj);
+        return *this;
+    }
     template <typename SerializableType> BinarySerializer &operator<<(std::vector<SerializableType> &obj) {
         int len = obj.size();
         serialize(*this, len);
@@ -170,8 +253,64 @@ private:
     std::ostringstream os;
 };
 
+template <typename SerializableType> void serialize(BinarySerializer &s, std::deque<SerializableType> &obj) {
+    int len = obj.size();
+    serialize(s, len);
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+        serialize(s, *it);
+    }
+}
+
+template <typename SerializableTypeA, typename SerializableTypeB>
+void serialize(BinarySerializer &s, std::pair<SerializableTypeA, SerializableTypeB> &obj) {
+    serialize(s, obj.first);
+    serialize(s, obj.second);
+}
+
+// tuple and array sizes are part of the type, so no length prefix is written for them
+template <typename... SerializableTypes> void serialize(BinarySerializer &s, std::tuple<SerializableTypes...> &obj) {
+    std::apply([&s](auto &...elems) { (serialize(s, elems), ...); }, obj);
+}
+
+template <typename SerializableType, size_t N>
+void serialize(BinarySerializer &s, std::array<SerializableType, N> &obj) {
+    if constexpr (std::is_arithmetic<SerializableType>::value && !std::is_same<SerializableType, bool>::value) {
+        s.outStream().write((const char *)obj.data(), sizeof(SerializableType) * N);
+    } else {
+        for (size_t i = 0; i < N; ++i) {
+            serialize(s, obj[i]);
+        }
+    }
+}
+
+template <typename SerializableType> void serialize(BinarySerializer &s, std::optional<SerializableType> &obj) {
+    bool has_value = obj.has_value();
+    serialize(s, has_value);
+    if (has_value)
+        serialize(s, *obj);
+}
+
+// one tag byte holding the alternative index, followed by the alternative itself
+template <typename... SerializableTypes> void serialize(BinarySerializer &s, std::variant<SerializableTypes...> &obj) {
+    static_assert(sizeof...(SerializableTypes) <= 256, "variant index must fit in one tag byte");
+    unsigned char tag = obj.index();
+    serialize(s, tag);
+    std::visit([&s](auto &elem) { serialize(s, elem); }, obj);
+}
+
+template <size_t N> void serialize(BinarySerializer &s, std::bitset<N> &obj) {
+    std::string bits = packBits(obj, N);
+    s.outStream().write(bits.data(), bits.size());
+}
+
 template <typename SerializableType> void deserialize(BinaryDeserializer &s, SerializableType &obj) {
-    obj.deserialize(s);
+    if constexpr (std::is_enum<SerializableType>::value) {
+        std::underlying_type_t<SerializableType> tmp;
+        deserialize(s, tmp);
+        obj = static_cast<SerializableType>(tmp);
+    } else {
+        obj.deserialize(s);
+    }
 }
 
 template <typename SerializableType> void deserialize(BinaryDeserializer &s, SerializableType *ptr) {
@@ -234,6 +373,7 @@ public:
     BinaryDeserializer(const std::string &str) : binary(str) {}
     template <typename SerializableType> void operator>>(SerializableType &obj) { deserialize(*this, obj); }
     template <typename SerializableType> void operator>>(SerializableType *obj) { deserialize(*this, obj); }
+    void operator>>(std::vector<bool> &obj) { deserialize(*this, obj); }
     template <typename SerializableType> void operator>>(std::vector<SerializableType> &obj) {
         int len = obj.size();
         deserialize(*this, len);
@@ -290,8 +430,85 @@ private:
     std::string binary;
 };
 
+inline void checkRemaining(BinaryDeserializer &s, size_t size) {
+    if (s.str().size() < size)
+        throw std::out_of_range("binary has " + std::to_string(s.str().size()) + " bytes left, " +
+                                std::to_string(size) + " needed");
+}
+
+template <typename SerializableType> void deserialize(BinaryDeserializer &s, std::deque<SerializableType> &obj) {
+    int len = 0;
+    deserialize(s, len);
+    for (int i = 0; i < len; ++i) {
+        SerializableType tmp;
+        deserialize(s, tmp);
+        obj.emplace_back(tmp);
+    }
+}
+
+template <typename SerializableTypeA, typename SerializableTypeB>
+void deserialize(BinaryDeserializer &s, std::pair<SerializableTypeA, SerializableTypeB> &obj) {
+    deserialize(s, obj.first);
+    deserialize(s, obj.second);
+}
+
+template <typename... SerializableTypes>
+void deserialize(BinaryDeserializer &s, std::tuple<SerializableTypes...> &obj) {
+    std::apply([&s](auto &...elems) { (deserialize(s, elems), ...); }, obj);
+}
+
+template <typename SerializableType, size_t N>
+void deserialize(BinaryDeserializer &s, std::array<SerializableType, N> &obj) {
+    if constexpr (std::is_arithmetic<SerializableType>::value && !std::is_same<SerializableType, bool>::value) {
+        checkRemaining(s, sizeof(SerializableType) * N);
+        memcpy(obj.data(), s.str().data(), sizeof(SerializableType) * N);
+        s.str() = s.str().substr(sizeof(SerializableType) * N);
+    } else {
+        for (size_t i = 0; i < N; ++i) {
+            deserialize(s, obj[i]);
+        }
+    }
+}
+
+template <typename SerializableType> void deserialize(BinaryDeserializer &s, std::optional<SerializableType> &obj) {
+    bool has_value = false;
+    deserialize(s, has_value);
+    if (has_value)
+        deserialize(s, obj.emplace());
+    else
+        obj.reset();
+}
+
+template <typename... SerializableTypes, size_t... Indices>
+void deserializeVariant(BinaryDeserializer &s, std::variant<SerializableTypes...> &obj, size_t tag,
+                        std::index_sequence<Indices...>) {
+    ((tag == Indices ? deserialize(s, obj.template emplace<Indices>()) : void()), ...);
+}
+
+template <typename... SerializableTypes>
+void deserialize(BinaryDeserializer &s, std::variant<SerializableTypes...> &obj) {
+    unsigned char tag = 0;
+    deserialize(s, tag);
+    if (tag >= sizeof...(SerializableTypes))
+        throw std::out_of_range("variant tag " + std::to_string(tag) + " out of range");
+    deserializeVariant(s, obj, tag, std::index_sequence_for<SerializableTypes...>());
+}
+
+template <size_t N> void deserialize(BinaryDeserializer &s, std::bitset<N> &obj) {
+    checkRemaining(s, (N + 7) / 8);
+    for (size_t i = 0; i < N; ++i) {
+        obj[i] = unpackBit(s.str().data(), i);
+    }
+    s.str() = s.str().substr((N + 7) / 8);
+}
+
 template <typename SerializableType> void serialize(Json::Value &val, const std::string &name, SerializableType &obj) {
-    obj.serialize(val[name]);
+    if constexpr (std::is_enum<SerializableType>::value) {
+        auto tmp = static_cast<std::underlying_type_t<SerializableType>>(obj);
+        serialize(val, name, tmp);
+    } else {
+        obj.serialize(val[name]);
+    }
 }
 
 template <typename SerializableType>
@@ -351,14 +568,79 @@ void serialize(Json::Value &val, const std::string &name,
     serialize(val, name + "_value", tmp_value);
 }
 
+template <typename SerializableType>
+void serialize(Json::Value &val, const std::string &name, std::deque<SerializableType> &obj) {
+    int len = obj.size();
+    serialize(val[name], "size", len);
+    int i = 0;
+    for (auto it = obj.begin(); it != obj.end(); ++it, ++i) {
+        std::string data = "data_" + std::to_string(i);
+        serialize(val[name], data, *it);
+    }
+}
+
+template <typename SerializableTypeA, typename SerializableTypeB>
+void serialize(Json::Value &val, const std::string &name, std::pair<SerializableTypeA, SerializableTypeB> &obj) {
+    serialize(val[name], "first", obj.first);
+    serialize(val[name], "second", obj.second);
+}
+
+template <typename... SerializableTypes>
+void serialize(Json::Value &val, const std::string &name, std::tuple<SerializableTypes...> &obj) {
+    int i = 0;
+    std::apply([&val, &name, &i](auto &...elems) { (serialize(val[name], "data_" + std::to_string(i++), elems), ...); },
+               obj);
+}
+
+template <typename SerializableType, size_t N>
+void serialize(Json::Value &val, const std::string &name, std::array<SerializableType, N> &obj) {
+    for (size_t i = 0; i < N; ++i) {
+        std::string data = "data_" + std::to_string(i);
+        serialize(val[name], data, obj[i]);
+    }
+}
+
+template <typename SerializableType>
+void serialize(Json::Value &val, const std::string &name, std::optional<SerializableType> &obj) {
+    bool has_value = obj.has_value();
+    serialize(val[name], "has_value", has_value);
+    if (has_value)
+        serialize(val[name], "value", *obj);
+}
+
+template <typename... SerializableTypes>
+void serialize(Json::Value &val, const std::string &name, std::variant<SerializableTypes...> &obj) {
+    unsigned long long index = obj.index();
+    serialize(val[name], "index", index);
+    std::visit([&val, &name](auto &elem) { serialize(val[name], "value", elem); }, obj);
+}
+
+// Json keeps bits as a readable '0'/'1' string, most significant bit first like std::bitset::to_string
+template <size_t N> void serialize(Json::Value &val, const std::string &name, std::bitset<N> &obj) {
+    val[name] = obj.to_string();
+}
+
 class JsonSerializer {
 public:
-    JsonSerializer(const std::string &name) { filename = name + ".json"; }
+    JsonSerializer(const std::string &name) {
+        filename = name + ".json";
+        // NaN and +-Infinity are written as literals instead of null and 1e+9999, which don't read back
+        json_writer["indentation"] = "   ";
+        json_writer["useSpecialFloats"] = true;
+    }
     template <typename SerializableType>
     JsonSerializer &transferToJson(const std::string &name, SerializableType &obj) {
         serialize(root, name, obj);
         std::ofstream file_stream(filename, std::ios::out | std::ios::app);
-        file_stream << json_writer.write(root);
+        file_stream << Json::writeString(json_writer, root);
+        file_stream.close();
+        root.clear();
+        return *this;
+    }
+    JsonSerializer &transferToJson(const std::string &name, std::vector<bool> &obj) {
+        serialize(root, name, obj);
+        std::ofstream file_stream(filename, std::ios::out | std::ios::app);
+        file_stream << Json::writeString(json_writer, root);
         file_stream.close();
         root.clear();
         return *this;
@@ -373,7 +655,7 @@ public:
             serialize(root[name], data, obj[i]);
         }
         std::ofstream file_stream(filename, std::ios::out | std::ios::app);
-        file_stream << json_writer.write(root);
+        file_stream << Json::writeString(json_writer, root);
         file_stream.close();
         root.clear();
         return *this;
@@ -388,7 +670,7 @@ public:
             serialize(root[name], data, *it);
         }
         std::ofstream file_stream(filename, std::ios::out | std::ios::app);
-        file_stream << json_writer.write(root);
+        file_stream << Json::writeString(json_writer, root);
         file_stream.close();
         root.clear();
         return *this;
@@ -399,7 +681,7 @@ public:
         std::copy(obj.begin(), obj.end(), std::back_inserter(tmp));
         serialize(root, name, tmp);
         std::ofstream file_stream(filename, std::ios::out | std::ios::app);
-        file_stream << json_writer.write(root);
+        file_stream << Json::writeString(json_writer, root);
         file_stream.close();
         root.clear();
         return *this;
@@ -416,7 +698,7 @@ public:
         serialize(root, name + "_key", tmp_key);
         serialize(root, name + "_value", tmp_value);
         std::ofstream file_stream(filename, std::ios::out | std::ios::app);
-        file_stream << json_writer.write(root);
+        file_stream << Json::writeString(json_writer, root);
         file_stream.close();
         root.clear();
         return *this;
@@ -434,7 +716,7 @@ public:
         serialize(root, name + "_key", tmp_key);
         serialize(root, name + "_value", tmp_value);
         std::ofstream file_stream(filename, std::ios::out | std::ios::app);
-        file_stream << json_writer.write(root);
+        file_stream << Json::writeString(json_writer, root);
         file_stream.close();
         root.clear();
         return *this;
@@ -447,12 +729,18 @@ public:
 private:
     std::string filename;
     Json::Value root;
-    Json::StyledWriter json_writer;
+    Json::StreamWriterBuilder json_writer;
 };
 
 template <typename SerializableType>
 void deserialize(Json::Value &val, const std::string &name, SerializableType &obj) {
-    obj.deserialize(val[name]);
+    if constexpr (std::is_enum<SerializableType>::value) {
+        std::underlying_type_t<SerializableType> tmp;
+        deserialize(val, name, tmp);
+        obj = static_cast<SerializableType>(tmp);
+    } else {
+        obj.deserialize(val[name]);
+    }
 }
 
 template <typename SerializableType>
@@ -467,19 +755,91 @@ void deserialize(Json::Value &val, const std::string &name, std::vector<Serializ
     }
 }
 
+template <typename SerializableType>
+void deserialize(Json::Value &val, const std::string &name, std::deque<SerializableType> &obj) {
+    int len = 0;
+    deserialize(val[name], "size", len);
+    for (int i = 0; i < len; ++i) {
+        SerializableType tmp;
+        std::string data = "data_" + std::to_string(i);
+        deserialize(val[name], data, tmp);
+        obj.emplace_back(tmp);
+    }
+}
+
+template <typename SerializableTypeA, typename SerializableTypeB>
+void deserialize(Json::Value &val, const std::string &name, std::pair<SerializableTypeA, SerializableTypeB> &obj) {
+    deserialize(val[name], "first", obj.first);
+    deserialize(val[name], "second", obj.second);
+}
+
+template <typename... SerializableTypes>
+void deserialize(Json::Value &val, const std::string &name, std::tuple<SerializableTypes...> &obj) {
+    int i = 0;
+    std::apply(
+        [&val, &name, &i](auto &...elems) { (deserialize(val[name], "data_" + std::to_string(i++), elems), ...); },
+        obj);
+}
+
+template <typename SerializableType, size_t N>
+void deserialize(Json::Value &val, const std::string &name, std::array<SerializableType, N> &obj) {
+    for (size_t i = 0; i < N; ++i) {
+        std::string data = "data_" + std::to_string(i);
+        deserialize(val[name], data, obj[i]);
+    }
+}
+
+template <typename SerializableType>
+void deserialize(Json::Value &val, const std::string &name, std::optional<SerializableType> &obj) {
+    bool has_value = false;
+    deserialize(val[name], "has_value", has_value);
+    if (has_value)
+        deserialize(val[name], "value", obj.emplace());
+    else
+        obj.reset();
+}
+
+template <typename... SerializableTypes, size_t... Indices>
+void deserializeVariant(Json::Value &val, const std::string &name, std::variant<SerializableTypes...> &obj,
+                        size_t tag, std::index_sequence<Indices...>) {
+    ((tag == Indices ? deserialize(val[name], "value", obj.template emplace<Indices>()) : void()), ...);
+}
+
+template <typename... SerializableTypes>
+void deserialize(Json::Value &val, const std::string &name, std::variant<SerializableTypes...> &obj) {
+    unsigned long long index = 0;
+    deserialize(val[name], "index", index);
+    if (index >= sizeof...(SerializableTypes))
+        throw std::out_of_range("variant index " + std::to_string(index) + " of " + name + " out of range");
+    deserializeVariant(val, name, obj, index, std::index_sequence_for<SerializableTypes...>());
+}
+
+template <size_t N> void deserialize(Json::Value &val, const std::string &name, std::bitset<N> &obj) {
+    obj = std::bitset<N>(val[name].asString());
+}
+
 class JsonDeserializer {
 public:
-    JsonDeserializer(const std::string &name) { filename = name + ".json"; }
+    JsonDeserializer(const std::string &name) {
+        filename = name + ".json";
+        json_reader["allowSpecialFloats"] = true;
+    }
     template <typename SerializableType> void transferToObject(const std::string &name, SerializableType &obj) {
         std::ifstream file_stream(filename, std::ios::in);
-        json_reader.parse(file_stream, root);
+        Json::parseFromStream(json_reader, file_stream, &root, nullptr);
+        deserialize(root, name, obj);
+        file_stream.close();
+    }
+    void transferToObject(const std::string &name, std::vector<bool> &obj) {
+        std::ifstream file_stream(filename, std::ios::in);
+        Json::parseFromStream(json_reader, file_stream, &root, nullptr);
         deserialize(root, name, obj);
         file_stream.close();
     }
     template <typename SerializableType>
     void transferToObject(const std::string &name, std::vector<SerializableType> &obj) {
         std::ifstream file_stream(filename, std::ios::in);
-        json_reader.parse(file_stream, root);
+        Json::parseFromStream(json_reader, file_stream, &root, nullptr);
         int len = 0;
         deserialize(root[name], "size", len);
         for (int i = 0; i < len; ++i) {
@@ -493,7 +853,7 @@ public:
     template <typename SerializableTypeA, typename SerializableTypeB>
     void transferToObject(const std::string &name, std::map<SerializableTypeA, SerializableTypeB> &obj) {
         std::ifstream file_stream(filename, std::ios::in);
-        json_reader.parse(file_stream, root);
+        Json::parseFromStream(json_reader, file_stream, &root, nullptr);
 
         std::vector<SerializableTypeA> tmp_key;
         std::vector<SerializableTypeB> tmp_value;
@@ -508,7 +868,7 @@ public:
     template <typename SerializableTypeA, typename SerializableTypeB>
     void transferToObject(const std::string &name, std::unordered_map<SerializableTypeA, SerializableTypeB> &obj) {
         std::ifstream file_stream(filename, std::ios::in);
-        json_reader.parse(file_stream, root);
+        Json::parseFromStream(json_reader, file_stream, &root, nullptr);
 
         std::vector<SerializableTypeA> tmp_key;
         std::vector<SerializableTypeB> tmp_value;
@@ -524,10 +884,12 @@ public:
 private:
     std::string filename;
     Json::Value root;
-    Json::Reader json_reader;
+    Json::CharReaderBuilder json_reader;
 };
 
+BASIC_TYPE_SERIALIZE_AND_DESERIALIZE(bool)
 BASIC_TYPE_SERIALIZE_AND_DESERIALIZE(char)
+BASIC_TYPE_SERIALIZE_AND_DESERIALIZE(signed char)
 BASIC_TYPE_SERIALIZE_AND_DESERIALIZE(unsigned char)
 BASIC_TYPE_SERIALIZE_AND_DESERIALIZE(short int)
 BASIC_TYPE_SERIALIZE_AND_DESERIALIZE(unsigned short int)
@@ -540,6 +902,40 @@ BASIC_TYPE_SERIALIZE_AND_DESERIALIZE(unsigned long long int)
 BASIC_TYPE_SERIALIZE_AND_DESERIALIZE(float)
 BASIC_TYPE_SERIALIZE_AND_DESERIALIZE(double)
 
+inline void serialize(BinarySerializer &s, std::vector<bool> &obj) {
+    int len = obj.size();
+    serialize(s, len);
+    std::string bits = packBits(obj, len);
+    s.outStream().write(bits.data(), bits.size());
+}
+
+inline void deserialize(BinaryDeserializer &s, std::vector<bool> &obj) {
+    int len = 0;
+    deserialize(s, len);
+    if (len < 0)
+        throw std::out_of_range("negative vector<bool> length " + std::to_string(len));
+    checkRemaining(s, ((size_t)len + 7) / 8);
+    for (int i = 0; i < len; ++i) {
+        obj.push_back(unpackBit(s.str().data(), i));
+    }
+    s.str() = s.str().substr((len + 7) / 8);
+}
+
+inline void serialize(Json::Value &val, const std::string &name, std::vector<bool> &obj) {
+    std::string bits;
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+        bits.push_back(*it ? '1' : '0');
+    }
+    val[name] = bits;
+}
+
+inline void deserialize(Json::Value &val, const std::string &name, std::vector<bool> &obj) {
+    std::string bits = val[name].asString();
+    for (auto it = bits.begin(); it != bits.end(); ++it) {
+        obj.push_back(*it == '1');
+    }
+}
+
 } // namespace Vernon
 
 #endif
@@ -0,0 +1,354 @@
+#ifndef TABLE_VIEW_H
+#define TABLE_VIEW_H
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <map>
+#include <set>
+#include <string.h>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Vernon {
+
+// Table layout: a binary format that can be read in place, field by field, without deserializing the whole object.
+//
+//   table  : int field_count | int offset_table | field payloads... | int offset[field_count]
+//   vector : int size | int stride | packed elements            (stride > 0, basic element types)
+//            int size | int stride | int offset[size] | payloads (stride == 0, variable-length element types)
+//   map    : table of two fields, 0 = key vector, 1 = value vector
+//   basic  : raw bytes, sizeof(Type)
+//
+// Offsets are relative to the start of the enclosing table or vector. A table's offset table trails its payloads, so
+// fields are written straight into the buffer before the field count is known. The field index is the order in
+// which a type writes its members in serialize(TableSerializer &), which is the schema the reader has to agree on.
+
+class TableBuffer;
+class TableSerializer;
+class TableView;
+class VectorView;
+
+template <typename Type> struct TableTraits {
+    static const int stride = 0;
+};
+
+#define BASIC_TYPE_TABLE_SERIALIZE(Type)                                                                               \
+    template <> struct TableTraits<Type> {                                                                             \
+        static const int stride = sizeof(Type);                                                                        \
+    };                                                                                                                 \
+    template <> inline void serialize(TableBuffer &buf, Type &obj) { buf.append((const char *)&obj, sizeof(Type)); }
+
+class TableBuffer {
+public:
+    void append(const char *data, int size) { binary.append(data, size); }
+    void appendInt(int value) { binary.append((const char *)&value, sizeof(int)); }
+    void patchInt(int pos, int value) { memcpy(&binary[pos], &value, sizeof(int)); }
+    int size() const { return binary.size(); }
+    void reset() { binary.clear(); }
+    std::string &str() { return binary; }
+    const std::string &str() const { return binary; }
+
+private:
+    std::string binary;
+};
+
+template <typename SerializableType> void serialize(TableBuffer &buf, SerializableType &obj);
+
+template <typename SerializableType> void serialize(TableBuffer &buf, SerializableType *ptr) { serialize(buf, *ptr); }
+
+template <typename SerializableType> void serialize(TableBuffer &buf, std::vector<SerializableType> &obj) {
+    int len = obj.size();
+    int stride = TableTraits<SerializableType>::stride;
+    int start = buf.size();
+    buf.appendInt(len);
+    buf.appendInt(stride);
+    if (stride > 0) {
+        for (int i = 0; i < len; ++i) {
+            serialize(buf, obj[i]);
+        }
+        return;
+    }
+    int offset_pos = buf.size();
+    for (int i = 0; i < len; ++i) {
+        buf.appendInt(0);
+    }
+    for (int i = 0; i < len; ++i) {
+        buf.patchInt(offset_pos + i * sizeof(int), buf.size() - start);
+        serialize(buf, obj[i]);
+    }
+}
+
+template <typename SerializableType> void serialize(TableBuffer &buf, std::list<SerializableType> &obj) {
+    std::vector<SerializableType> tmp;
+    std::copy(obj.begin(), obj.end(), std::back_inserter(tmp));
+    serialize(buf, tmp);
+}
+
+template <typename SerializableType> void serialize(TableBuffer &buf, std::set<SerializableType> &obj) {
+    std::vector<SerializableType> tmp;
+    std::copy(obj.begin(), obj.end(), std::back_inserter(tmp));
+    serialize(buf, tmp);
+}
+
+template <typename SerializableTypeA, typename SerializableTypeB>
+void serialize(TableBuffer &buf, std::map<SerializableTypeA, SerializableTypeB> &obj);
+
+template <typename SerializableTypeA, typename SerializableTypeB>
+void serialize(TableBuffer &buf, std::unordered_map<SerializableTypeA, SerializableTypeB> &obj);
+
+// Writes one table into a caller-owned buffer. Fields are appended in place; finish() adds the offset table once
+// the last field is written, and runs from the destructor if it wasn't called. To write an object as the root table
+// of a buffer, use serialize(TableBuffer &, obj).
+class TableSerializer {
+public:
+    explicit TableSerializer(TableBuffer &buf) : buffer(buf), start(buf.size()), finished(false) {
+        buffer.appendInt(0);
+        buffer.appendInt(0);
+    }
+    ~TableSerializer() { finish(); }
+    TableSerializer(const TableSerializer &) = delete;
+    TableSerializer &operator=(const TableSerializer &) = delete;
+    template <typename SerializableType> TableSerializer &operator<<(SerializableType &obj) {
+        offsets.push_back(buffer.size() - start);
+        serialize(buffer, obj);
+        return *this;
+    }
+    template <typename SerializableType> TableSerializer &operator<<(SerializableType *obj) {
+        offsets.push_back(buffer.size() - start);
+        serialize(buffer, obj);
+        return *this;
+    }
+    void finish() {
+        if (finished)
+            return;
+        finished = true;
+        int len = offsets.size();
+        buffer.patchInt(start, len);
+        buffer.patchInt(start + sizeof(int), buffer.size() - start);
+        for (int i = 0; i < len; ++i) {
+            buffer.appendInt(offsets[i]);
+        }
+    }
+
+private:
+    TableBuffer &buffer;
+    int start;
+    bool finished;
+    std::vector<int> offsets;
+};
+
+template <typename SerializableType> void serialize(TableBuffer &buf, SerializableType &obj) {
+    TableSerializer table(buf);
+    obj.serialize(table);
+    table.finish();
+}
+
+template <typename SerializableTypeA, typename SerializableTypeB>
+void serialize(TableBuffer &buf, std::map<SerializableTypeA, SerializableTypeB> &obj) {
+    std::vector<SerializableTypeA> tmp_key;
+    std::vector<SerializableTypeB> tmp_value;
+
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+        tmp_key.push_back(it->first);
+        tmp_value.push_back(it->second);
+    }
+
+    TableSerializer table(buf);
+    table << tmp_key << tmp_value;
+    table.finish();
+}
+
+template <typename SerializableTypeA, typename SerializableTypeB>
+void serialize(TableBuffer &buf, std::unordered_map<SerializableTypeA, SerializableTypeB> &obj) {
+    std::vector<SerializableTypeA> tmp_key;
+    std::vector<SerializableTypeB> tmp_value;
+
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+        tmp_key.push_back(it->first);
+        tmp_value.push_back(it->second);
+    }
+
+    TableSerializer table(buf);
+    table << tmp_key << tmp_value;
+    table.finish();
+}
+
+// Read-only views over a table layout buffer. They hold a pointer into the buffer plus its size, so the buffer must
+// outlive them, and nothing is decoded until a field or element is actually requested. Every read is checked against
+// the buffer: a missing field, out-of-range index, stride mismatch or corrupt offset yields the default value or an
+// invalid view instead of reading past the end. verify() additionally checks a table's or vector's own header and
+// offsets up front.
+
+class BufferView {
+public:
+    bool valid() const { return contains(0, 2 * sizeof(int)); }
+
+protected:
+    BufferView() : buffer(nullptr), buffer_size(0), pos(0) {}
+    BufferView(const char *data, long long size, long long start) : buffer(data), buffer_size(size), pos(start) {}
+    bool contains(long long rel, long long len) const {
+        long long abs = pos + rel;
+        return buffer && rel >= 0 && len >= 0 && abs <= buffer_size && len <= buffer_size - abs;
+    }
+    int readInt(long long rel) const {
+        int ret = 0;
+        if (contains(rel, sizeof(int)))
+            memcpy(&ret, buffer + pos + rel, sizeof(int));
+        return ret;
+    }
+    template <typename Type> Type read(long long rel, Type default_value) const {
+        static_assert(std::is_trivially_copyable<Type>::value, "only trivially copyable types can be read in place");
+        if (!contains(rel, sizeof(Type)))
+            return default_value;
+        Type ret;
+        memcpy(&ret, buffer + pos + rel, sizeof(Type));
+        return ret;
+    }
+
+    const char *buffer;
+    long long buffer_size;
+    long long pos;
+};
+
+class VectorView : public BufferView {
+    friend class TableView;
+
+public:
+    VectorView() {}
+    int size() const {
+        int len = readInt(0);
+        return len > 0 ? len : 0;
+    }
+    int stride() const { return readInt(sizeof(int)); }
+    template <typename Type> Type at(int i, Type default_value = Type()) const {
+        static_assert(std::is_trivially_copyable<Type>::value, "only trivially copyable types can be read in place");
+        if (stride() != (int)sizeof(Type) || i < 0 || i >= size())
+            return default_value;
+        return read<Type>(2 * sizeof(int) + (long long)i * sizeof(Type), default_value);
+    }
+    inline TableView tableAt(int i) const;
+    VectorView vectorAt(int i) const {
+        long long offset = elementOffset(i);
+        return offset < 0 ? VectorView() : VectorView(buffer, buffer_size, pos + offset);
+    }
+    template <typename Type> std::vector<Type> toVector() const {
+        static_assert(std::is_trivially_copyable<Type>::value, "only trivially copyable types can be read in place");
+        int len = size();
+        if (stride() != (int)sizeof(Type) || !contains(2 * sizeof(int), (long long)len * sizeof(Type)))
+            return std::vector<Type>();
+        std::vector<Type> ret(len);
+        if (len > 0)
+            memcpy(ret.data(), buffer + pos + 2 * sizeof(int), len * sizeof(Type));
+        return ret;
+    }
+    bool verify() const {
+        int len = readInt(0);
+        int elem_stride = stride();
+        if (!valid() || len < 0 || elem_stride < 0)
+            return false;
+        if (elem_stride > 0)
+            return contains(2 * sizeof(int), (long long)len * elem_stride);
+        if (!contains(2 * sizeof(int), (long long)len * sizeof(int)))
+            return false;
+        for (int i = 0; i < len; ++i) {
+            if (elementOffset(i) < 0)
+                return false;
+        }
+        return true;
+    }
+
+private:
+    VectorView(const char *data, long long size, long long start) : BufferView(data, size, start) {}
+    // offset of element i in a stride-0 vector, -1 if it is packed, out of range or points outside the buffer
+    long long elementOffset(int i) const {
+        if (stride() != 0 || i < 0 || i >= size())
+            return -1;
+        long long entry = 2 * sizeof(int) + (long long)i * sizeof(int);
+        if (!contains(entry, sizeof(int)))
+            return -1;
+        long long offset = readInt(entry);
+        return contains(offset, 1) ? offset : -1;
+    }
+};
+
+class TableView : public BufferView {
+    friend class VectorView;
+
+public:
+    TableView() {}
+    explicit TableView(const char *data, size_t size) : BufferView(data, size, 0) {}
+    explicit TableView(const std::string &str) : BufferView(str.data(), str.size(), 0) {}
+    explicit TableView(const TableBuffer &buf) : TableView(buf.str()) {}
+    TableView(std::string &&) = delete;
+    TableView(TableBuffer &&) = delete;
+    int fieldCount() const {
+        int len = readInt(0);
+        return len > 0 ? len : 0;
+    }
+    bool has(int index) const { return fieldOffset(index) >= 0; }
+    // missing fields (e.g. written by an older schema) read back as default_value
+    template <typename Type> Type field(int index, Type default_value = Type()) const {
+        static_assert(std::is_trivially_copyable<Type>::value, "only trivially copyable types can be read in place");
+        long long offset = fieldOffset(index);
+        return offset < 0 ? default_value : read<Type>(offset, default_value);
+    }
+    TableView table(int index) const {
+        long long offset = fieldOffset(index);
+        return offset < 0 ? TableView() : TableView(buffer, buffer_size, pos + offset);
+    }
+    VectorView vector(int index) const {
+        long long offset = fieldOffset(index);
+        return offset < 0 ? VectorView() : VectorView(buffer, buffer_size, pos + offset);
+    }
+    VectorView mapKeys(int index) const { return table(index).vector(0); }
+    VectorView mapValues(int index) const { return table(index).vector(1); }
+    bool verify() const {
+        int len = readInt(0);
+        if (!valid() || len < 0 || !contains(readInt(sizeof(int)), (long long)len * sizeof(int)))
+            return false;
+        for (int i = 0; i < len; ++i) {
+            if (fieldOffset(i) < 0)
+                return false;
+        }
+        return true;
+    }
+
+private:
+    TableView(const char *data, long long size, long long start) : BufferView(data, size, start) {}
+    // offset of field index, -1 if the field is missing or points outside the buffer
+    long long fieldOffset(int index) const {
+        if (index < 0 || index >= fieldCount())
+            return -1;
+        long long entry = (long long)readInt(sizeof(int)) + (long long)index * sizeof(int);
+        if (!contains(entry, sizeof(int)))
+            return -1;
+        long long offset = readInt(entry);
+        return contains(offset, 1) ? offset : -1;
+    }
+};
+
+inline TableView VectorView::tableAt(int i) const {
+    long long offset = elementOffset(i);
+    return offset < 0 ? TableView() : TableView(buffer, buffer_size, pos + offset);
+}
+
+BASIC_TYPE_TABLE_SERIALIZE(char)
+BASIC_TYPE_TABLE_SERIALIZE(unsigned char)
+BASIC_TYPE_TABLE_SERIALIZE(short int)
+BASIC_TYPE_TABLE_SERIALIZE(unsigned short int)
+BASIC_TYPE_TABLE_SERIALIZE(int)
+BASIC_TYPE_TABLE_SERIALIZE(unsigned int)
+BASIC_TYPE_TABLE_SERIALIZE(long int)
+BASIC_TYPE_TABLE_SERIALIZE(unsigned long int)
+BASIC_TYPE_TABLE_SERIALIZE(long long int)
+BASIC_TYPE_TABLE_SERIALIZE(unsigned long long int)
+BASIC_TYPE_TABLE_SERIALIZE(float)
+BASIC_TYPE_TABLE_SERIALIZE(double)
+
+} // namespace Vernon
+
+#endif
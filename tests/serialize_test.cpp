@@ -1,5 +1,8 @@
 #include "reflection/serialization.h"
+#include "reflection/table_view.h"
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 
 struct A {
@@ -14,6 +17,10 @@ struct A {
     {
         Vernon::serialize(val, "a", a);
     }
+    virtual void serialize(Vernon::TableSerializer& s)
+    {
+        s << a;
+    }
     virtual void deserialize(Vernon::BinaryDeserializer& s)
     {
         s >> a;
@@ -42,6 +49,11 @@ struct B: public A {
         A::serialize(val);
         Vernon::serialize(val, "b", b);
     }
+    void serialize(Vernon::TableSerializer& s) override
+    {
+        A::serialize(s);
+        s << b;
+    }
     void deserialize(Vernon::BinaryDeserializer& s) override
     {
         A::deserialize(s);
@@ -60,6 +72,97 @@ struct B: public A {
     int b;
 };
 
+struct Entity {
+    void serialize(Vernon::TableSerializer& s)
+    {
+        s << id << position << parts << tags;
+    }
+    int id;
+    std::vector<float> position;
+    std::vector<B> parts;
+    std::map<int, std::vector<int>> tags;
+};
+
+enum class Color : unsigned char { Red, Green, Blue };
+
+struct Extended {
+    void serialize(Vernon::BinarySerializer& s)
+    {
+        s << flag << flags << pair << tuple << array << deque << optional << empty << variant << bits << color << special;
+    }
+    void serialize(Json::Value& val)
+    {
+        Vernon::serialize(val, "flag", flag);
+        Vernon::serialize(val, "flags", flags);
+        Vernon::serialize(val, "pair", pair);
+        Vernon::serialize(val, "tuple", tuple);
+        Vernon::serialize(val, "array", array);
+        Vernon::serialize(val, "deque", deque);
+        Vernon::serialize(val, "optional", optional);
+        Vernon::serialize(val, "empty", empty);
+        Vernon::serialize(val, "variant", variant);
+        Vernon::serialize(val, "bits", bits);
+        Vernon::serialize(val, "color", color);
+        Vernon::serialize(val, "special", special);
+    }
+    void deserialize(Vernon::BinaryDeserializer& s)
+    {
+        s >> flag;
+        s >> flags;
+        s >> pair;
+        s >> tuple;
+        s >> array;
+        s >> deque;
+        s >> optional;
+        s >> empty;
+        s >> variant;
+        s >> bits;
+        s >> color;
+        s >> special;
+    }
+    void deserialize(Json::Value& val)
+    {
+        Vernon::deserialize(val, "flag", flag);
+        Vernon::deserialize(val, "flags", flags);
+        Vernon::deserialize(val, "pair", pair);
+        Vernon::deserialize(val, "tuple", tuple);
+        Vernon::deserialize(val, "array", array);
+        Vernon::deserialize(val, "deque", deque);
+        Vernon::deserialize(val, "optional", optional);
+        Vernon::deserialize(val, "empty", empty);
+        Vernon::deserialize(val, "variant", variant);
+        Vernon::deserialize(val, "bits", bits);
+        Vernon::deserialize(val, "color", color);
+        Vernon::deserialize(val, "special", special);
+    }
+    void check(const std::string& mode, Extended& other) {
+        std::cout << mode << " bool: " << (flag == other.flag) << std::endl;
+        std::cout << mode << " vector<bool>: " << (flags == other.flags) << std::endl;
+        std::cout << mode << " pair: " << (pair == other.pair) << std::endl;
+        std::cout << mode << " tuple: " << (tuple == other.tuple) << std::endl;
+        std::cout << mode << " array: " << (array == other.array) << std::endl;
+        std::cout << mode << " deque: " << (deque == other.deque) << std::endl;
+        std::cout << mode << " optional: " << (optional == other.optional && empty == other.empty) << std::endl;
+        std::cout << mode << " variant: " << (variant == other.variant) << std::endl;
+        std::cout << mode << " bitset: " << (bits == other.bits) << std::endl;
+        std::cout << mode << " enum: " << (color == other.color) << std::endl;
+        std::cout << mode << " inf and nan: "
+                  << (special.first == other.special.first && std::isnan(other.special.second)) << std::endl;
+    }
+    bool flag = false;
+    std::vector<bool> flags;
+    std::pair<int, std::vector<double>> pair;
+    std::tuple<int, float, std::vector<int>> tuple;
+    std::array<int, 3> array = {0, 0, 0};
+    std::deque<std::pair<int, int>> deque;
+    std::optional<std::vector<int>> optional;
+    std::optional<int> empty = 5;
+    std::variant<int, double, std::vector<int>> variant;
+    std::bitset<12> bits;
+    Color color = Color::Red;
+    std::pair<float, double> special = {0.0f, 0.0};
+};
+
 int main() {
     // 1. binary serializer and deserializer test
     // serialize 2-level stl vector
@@ -148,6 +251,108 @@ int main() {
     B new_json_b;
     json_deserializer.transferToObject("B", new_json_b);
     new_json_b.print();
+    // 3. table serializer and lazy view test
+    Entity entity;
+    entity.id = 42;
+    entity.position = std::vector<float>{1.5f, 2.5f, 3.5f};
+    entity.parts.resize(2);
+    entity.parts[1].b = 77;
+    entity.tags[3] = std::vector<int>{7, 8};
+    entity.tags[5] = std::vector<int>{9};
+    Vernon::TableBuffer table_buffer;
+    Vernon::serialize(table_buffer, entity);
+    std::cout<<"table size = "<<table_buffer.size()<<std::endl;
+    // read single fields straight from the buffer, without constructing an Entity
+    Vernon::TableView entity_view(table_buffer);
+    std::cout<<"verify = "<<entity_view.verify()<<std::endl;
+    std::cout<<"id = "<<entity_view.field<int>(0)<<std::endl;
+    Vernon::VectorView position_view = entity_view.vector(1);
+    std::cout<<"position size = "<<position_view.size()<<", position[2] = "<<position_view.at<float>(2)<<std::endl;
+    Vernon::VectorView parts_view = entity_view.vector(2);
+    std::cout<<"parts size = "<<parts_view.size()<<", parts[1].b = "<<parts_view.tableAt(1).field<int>(1)<<std::endl;
+    Vernon::VectorView tag_keys = entity_view.mapKeys(3);
+    Vernon::VectorView tag_values = entity_view.mapValues(3);
+    for (int i = 0; i < tag_keys.size(); ++i) {
+        std::cout<<"key="<<tag_keys.at<int>(i)<<", value=";
+        std::vector<int> value = tag_values.vectorAt(i).toVector<int>();
+        for (int j = 0; j < (int)value.size(); ++j) {
+            std::cout << value[j] << " ";
+        }
+        std::cout<<std::endl;
+    }
+    // fields beyond the written schema fall back to the default value
+    std::cout<<"missing field = "<<entity_view.field<int>(9, -1)<<std::endl;
+    // out-of-range indices and stride mismatches fall back to the default value or an invalid view
+    std::cout<<"out of range = "<<tag_values.vectorAt(0).at<int>(100, -1)<<std::endl;
+    std::cout<<"stride mismatch = "<<parts_view.at<int>(0, -1)<<", "<<position_view.tableAt(0).valid()<<std::endl;
+    // a truncated buffer fails verification and never reads past its end
+    std::string truncated = table_buffer.str().substr(0, table_buffer.size() / 2);
+    Vernon::TableView truncated_view(truncated);
+    std::cout<<"truncated verify = "<<truncated_view.verify()<<", id = "<<truncated_view.field<int>(0, -1)<<std::endl;
+    // 4. extended container and vocabulary type test
+    Extended extended;
+    extended.flag = true;
+    extended.flags = std::vector<bool>{true, false, true, true, false, false, false, true, true, false};
+    extended.pair = std::make_pair(7, std::vector<double>{0.5, 1.25});
+    extended.tuple = std::make_tuple(3, 4.5f, std::vector<int>{1, 2});
+    extended.array = {10, 200, 3000};
+    extended.deque = std::deque<std::pair<int, int>>{{1, 2}, {3, 4}};
+    extended.optional = std::vector<int>{6, 7};
+    extended.empty.reset();
+    extended.variant = std::vector<int>{8, 9};
+    extended.bits = std::bitset<12>(0xa5b);
+    extended.color = Color::Blue;
+    extended.special = std::make_pair(-std::numeric_limits<float>::infinity(), std::nan(""));
+    // serialize extended types to binary
+    serializer.reset();
+    serializer << extended;
+    std::cout<<"binary size = "<<serializer.str().size()<<std::endl;
+    // deserialize extended types from binary
+    deserialier.reset(serializer.str());
+    Extended new_extended;
+    deserialier >> new_extended;
+    extended.check("binary", new_extended);
+    // a length prefix longer than the remaining binary is reported before anything is read
+    serializer.reset();
+    int bad_len = 1000;
+    serializer << bad_len;
+    deserialier.reset(serializer.str());
+    std::vector<bool> short_flags;
+    try {
+        deserialier >> short_flags;
+        std::cout<<"binary length check: 0"<<std::endl;
+    } catch (const std::out_of_range &e) {
+        std::cout<<"binary length check: 1"<<std::endl;
+    }
+    // a corrupt variant tag is reported instead of leaving the stream misaligned
+    serializer.reset();
+    unsigned char bad_tag = 7;
+    serializer << bad_tag;
+    deserialier.reset(serializer.str());
+    std::variant<int, double> bad_variant = 3.0;
+    try {
+        deserialier >> bad_variant;
+        std::cout<<"binary variant tag check: 0"<<std::endl;
+    } catch (const std::out_of_range &e) {
+        std::cout<<"binary variant tag check: 1"<<std::endl;
+    }
+    // serialize extended types to json
+    json_serializer.reset();
+    json_serializer.transferToJson("extended", extended);
+    // deserialize extended types from json
+    Extended new_json_extended;
+    json_deserializer.transferToObject("extended", new_json_extended);
+    extended.check("json", new_json_extended);
+    // a Json variant index is range checked before it is narrowed
+    Json::Value bad_json;
+    bad_json["variant"]["index"] = 258;
+    bad_json["variant"]["value"] = 1;
+    try {
+        Vernon::deserialize(bad_json, "variant", bad_variant);
+        std::cout<<"json variant index check: 0"<<std::endl;
+    } catch (const std::out_of_range &e) {
+        std::cout<<"json variant index check: 1"<<std::endl;
+    }
 
 	return 0;
 }